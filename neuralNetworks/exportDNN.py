@@ -0,0 +1,89 @@
+# License
+#  This program is part of pythonPal4Foam.
+
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published
+#  by the Free Software Foundation, either version 3 of the License,
+#  or (at your option) any later version.
+
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#  See the GNU General Public License for more details. You should have
+#  received a copy of the GNU General Public License along with this
+#  program. If not, see <https://www.gnu.org/licenses/>.
+
+# Description
+#  This script exports a trained dense Keras neural network and its min-max
+#  scalers to an OpenFOAM dictionary, which can be read by the native
+#  inference backend of the pythonLinearElastic mechanical law
+#  ("inferenceBackend native;").
+#
+#  Usage:
+#      python exportDNN.py [DNN.h5] [x_scaler.joblib] [y_scaler.joblib]
+#          [constant/DNNCoeffs]
+
+# Author
+#  Simon A. Rodriguez, UCD. All rights reserved
+#  Philip Cardiff, UCD. All rights reserved
+
+import os
+import sys
+os.environ['TF_CPP_MIN_LOG_LEVEL'] = '1' # Disable tf warnings
+from tensorflow import keras
+from joblib import load
+
+def writeList(f, indent, name, values):
+    f.write(indent + name + ' ' + str(len(values)) + '(')
+    f.write(' '.join(repr(float(v)) for v in values))
+    f.write(');\n')
+
+def writeScaler(f, name, scaler):
+    # MinMaxScaler: x_scaled = x*scale_ + min_
+    f.write(name + '\n{\n')
+    writeList(f, '    ', 'scale', scaler.scale_)
+    writeList(f, '    ', 'min', scaler.min_)
+    f.write('}\n\n')
+
+def exportDNN(model_file, x_scaler_file, y_scaler_file, output_file):
+    model = keras.models.load_model(model_file)
+    x_scaler = load(x_scaler_file)
+    y_scaler = load(y_scaler_file)
+
+    layers = [layer for layer in model.layers if layer.get_weights()]
+
+    with open(output_file, 'w') as f:
+        f.write('FoamFile\n{\n')
+        f.write('    version     2.0;\n')
+        f.write('    format      ascii;\n')
+        f.write('    class       dictionary;\n')
+        f.write('    object      ' + os.path.basename(output_file) + ';\n')
+        f.write('}\n\n')
+
+        writeScaler(f, 'inputScaler', x_scaler)
+        writeScaler(f, 'outputScaler', y_scaler)
+
+        f.write('nLayers     ' + str(len(layers)) + ';\n\n')
+
+        for i, layer in enumerate(layers):
+            if not isinstance(layer, keras.layers.Dense):
+                sys.exit('Only Dense layers are supported: ' + layer.name)
+
+            # The kernel is stored as nInputs x nOutputs
+            kernel, bias = layer.get_weights()
+            f.write('layer' + str(i) + '\n{\n')
+            f.write('    activation  '
+                    + layer.get_config()['activation'] + ';\n')
+            f.write('    nInputs     ' + str(kernel.shape[0]) + ';\n')
+            f.write('    nOutputs    ' + str(kernel.shape[1]) + ';\n')
+            writeList(f, '    ', 'weights', kernel.flatten())
+            writeList(f, '    ', 'biases', bias)
+            f.write('}\n\n')
+
+if __name__ == '__main__':
+    args = sys.argv[1:] + [None]*4
+    exportDNN(args[0] or 'DNN.h5',
+              args[1] or 'x_scaler.joblib',
+              args[2] or 'y_scaler.joblib',
+              args[3] or os.path.join('constant', 'DNNCoeffs'))
@@ -28,7 +28,6 @@ import tensorflow as tf
 from tensorflow import keras
 from joblib import load
 import sklearn
-import ctypes as C
 
 model = keras.models.load_model("DNN.h5")
 
@@ -36,30 +35,63 @@ model = keras.models.load_model("DNN.h5")
 x_scaler = load('x_scaler.joblib')
 y_scaler = load('y_scaler.joblib')
 
-def predict():
-    data_pointer_strain = C.cast(epsilon_address, C.POINTER(C.c_double))
-    data_pointer_stress = C.cast(sigma_address, C.POINTER(C.c_double))
-    strain_tensor = np.ctypeslib.as_array(data_pointer_strain, shape=(SIZE,6))
-    stress_tensor = np.ctypeslib.as_array(data_pointer_stress, shape=(SIZE,6))
+#Reorder the components of strain to match the order in the
+#trained NN
+#Order NN: e_xx, e_yy, e_zz, e_xy, e_yz, e_zx
+#Order OpenFOAM: e_xx, e__xy, e_xz, e_yy, e_yz, e_zz
+#The permutation swaps pairs of components so it is its own inverse
+order = [0, 3, 5, 1, 4, 2]
 
-    #Reorder the components of strain to match the order in the
-    #trained NN
-    #Order NN: e_xx, e_yy, e_zz, e_xy, e_yz, e_zx
-    #Order OpenFOAM: e_xx, e__xy, e_xz, e_yy, e_yz, e_zz
-    original_strain_tensor = np.copy(strain_tensor)
-    strain_tensor[:, 1] = original_strain_tensor[:, 3]
-    strain_tensor[:, 2] = original_strain_tensor[:, 5]
-    strain_tensor[:, 3] = original_strain_tensor[:, 1]
-    strain_tensor[:, 5] = original_strain_tensor[:, 2]
-    strain_tensor_scaled = x_scaler.transform(strain_tensor)
-    strain_tensor_scaled_reshaped = strain_tensor_scaled.reshape(1, strain_tensor.shape[0],6)
-    prediction_scaled = model.predict(strain_tensor_scaled_reshaped)
-    prediction_output_scaled = prediction_scaled.reshape(strain_tensor.shape[0], 6)
-    stress_tensor[:, :] = y_scaler.inverse_transform(prediction_output_scaled)
+# Evaluate the network for the (N, 6) scaled strain
+# The model is always called with a (1, N, 6) input
+def predict_scaled(strain_tensor_scaled):
+    n = strain_tensor_scaled.shape[0]
+    prediction_scaled = model.predict(strain_tensor_scaled.reshape(1, n, 6))
+    return prediction_scaled.reshape(n, 6)
+
+# strain_tensor and stress_tensor are (N, 6) views of the OpenFOAM fields
+# The strain is read-only and the stress is updated in place
+# stiffness is an (N, 6, 6) view, only passed with "zeroStrainTangent yes;",
+# where stiffness[i, r, k] is d(stress[i, r])/d(strain[i, k])
+def predict(strain_tensor, stress_tensor, stiffness=None):
+    strain_tensor_scaled = x_scaler.transform(strain_tensor[:, order])
+    n = strain_tensor.shape[0]
+
+    if stiffness is None:
+        prediction_output_scaled = predict_scaled(strain_tensor_scaled)
+    else:
+        #Evaluate the stress and its Jacobian with respect to the scaled
+        #strain in the same pass, with the same (1, N, 6) input. The stress of
+        #each value only depends on its own strain, so row r of the Jacobian
+        #of every value is the gradient of the sum of stress component r.
+        x = tf.constant(strain_tensor_scaled.reshape(1, n, 6), dtype=tf.float32)
+        with tf.GradientTape(persistent=True) as tape:
+            tape.watch(x)
+            y = model(x, training=False)
+            y_components = [tf.reduce_sum(y[..., r]) for r in range(6)]
+        jacobian_scaled = np.stack(
+            [tape.gradient(y_components[r], x).numpy().reshape(n, 6)
+             for r in range(6)],
+            axis=1)
+        del tape
+        prediction_output_scaled = y.numpy().reshape(n, 6)
+
+        #Check that the stress matches the stress without the tangent
+        prediction_check = predict_scaled(strain_tensor_scaled)
+        if not np.allclose(prediction_output_scaled, prediction_check,
+                           rtol=1e-5, atol=1e-6):
+            raise ValueError(
+                "The stress calculated with the tangent differs from the "
+                "stress calculated without it by up to "
+                + str(np.abs(prediction_output_scaled
+                             - prediction_check).max()))
+
+        #Chain rule through the min-max scalers, then reorder the rows and
+        #columns, just like the strains
+        jacobian = jacobian_scaled \
+            * x_scaler.scale_[np.newaxis, np.newaxis, :] \
+            / y_scaler.scale_[np.newaxis, :, np.newaxis]
+        stiffness[:, :, :] = jacobian[:, order][:, :, order]
 
     #Reorder stress, just like strains
-    original_stress_tensor = np.copy(stress_tensor)
-    stress_tensor[:, 1] = original_stress_tensor[:, 3]
-    stress_tensor[:, 2] = original_stress_tensor[:, 5]
-    stress_tensor[:, 3] = original_stress_tensor[:, 1]
-    stress_tensor[:, 5] = original_stress_tensor[:, 2]  
+    stress_tensor[:, :] = y_scaler.inverse_transform(prediction_output_scaled)[:, order]
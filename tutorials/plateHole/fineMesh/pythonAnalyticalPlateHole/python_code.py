@@ -22,18 +22,22 @@
 #  Philip Cardiff, UCD. All rights reserved
 
 import numpy as np
-import ctypes as C
 
 E = 200e9 #Young's modulus
 v = 0.3 #Poisson's ratio
 lame_1 = E * v / ((1 + v) * (1 - 2 * v))
 lame_2 = E / (2 * (1 + v))
 
-def predict():
-    data_pointer_strain = C.cast(epsilon_address,C.POINTER(C.c_double))
-    data_pointer_stress = C.cast(sigma_address,C.POINTER(C.c_double))
-    strain_tensor = np.ctypeslib.as_array(data_pointer_strain,shape=(SIZE,6))
-    stress_tensor = np.ctypeslib.as_array(data_pointer_stress,shape=(SIZE,6))
+# Constant tangent stiffness d(stress)/d(strain) in the OpenFOAM order
+normal = [0, 3, 5]
+tangent = np.zeros((6, 6))
+tangent[np.ix_(normal, normal)] = lame_1
+tangent[np.diag_indices(6)] += 2 * lame_2
+
+# strain_tensor and stress_tensor are (N, 6) views of the OpenFOAM fields
+# Order OpenFOAM: xx, xy, xz, yy, yz, zz
+# stiffness is an (N, 6, 6) view, only passed with "zeroStrainTangent yes;"
+def predict(strain_tensor, stress_tensor, stiffness=None):
     stress_tensor[:, 0] = 2 * lame_2 * strain_tensor[:, 0] \
         + lame_1 * (strain_tensor[:, 0] \
         + strain_tensor[:, 3] + strain_tensor[:, 5])
@@ -45,4 +49,6 @@ def predict():
     stress_tensor[:, 4] = 2 * lame_2 * strain_tensor[:, 4]
     stress_tensor[:, 5] = 2 * lame_2 * strain_tensor[:, 5] \
         + lame_1 * (strain_tensor[:, 0] \
-        + strain_tensor[:, 3] + strain_tensor[:, 5])
\ No newline at end of file
+        + strain_tensor[:, 3] + strain_tensor[:, 5])
+    if stiffness is not None:
+        stiffness[:] = tangent
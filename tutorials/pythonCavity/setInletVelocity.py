@@ -19,20 +19,13 @@
 #  Philip Cardiff, UCD. All rights reserved
 
 import numpy as np
-import ctypes as C
 
-def calculate():
-    data_pointer_face_centres = C.cast(CAddress, C.POINTER(C.c_double))
-    face_centres = np.ctypeslib.as_array(data_pointer_face_centres, shape = (SIZE, 3))
-    data_pointer_velocities = C.cast(velocitiesAddress, C.POINTER(C.c_double))
-    velocities = np.ctypeslib.as_array(data_pointer_velocities, shape = (SIZE, 3))
+# Calculate the patch velocities as a function of the face centres and time
+# face_centres and velocities are (N, 3) views of the OpenFOAM fields; the
+# velocities are updated in place
+def calculate(face_centres, velocities, time):
+    # Calculate values using the x coordinates and time
+    x = face_centres[:, 0]
 
-    if face_centres.shape[0] != 0:
-        # Initialise result
-        result = np.zeros(shape = face_centres.shape)
-
-        # Calculate values using the x coordinates and time
-        x = face_centres[:, 0]
-
-        # Update the velocity field
-        velocities[:, 0] = np.sin(time * np.pi) * np.sin(x * 40 * np.pi)
+    # Update the velocity field
+    velocities[:, 0] = np.sin(time * np.pi) * np.sin(x * 40 * np.pi)
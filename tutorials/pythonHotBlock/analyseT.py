@@ -0,0 +1,47 @@
+# License
+#  This program is part of pythonPal4Foam.
+
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published
+#  by the Free Software Foundation, either version 3 of the License,
+#  or (at your option) any later version.
+
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#  See the GNU General Public License for more details. You should have
+#  received a copy of the GNU General Public License along with this
+#  program. If not, see <https://www.gnu.org/licenses/>.
+
+# Description
+#  In-situ analysis of the temperature field, called by the
+#  pythonFunctionObject function object during the run.
+#  The returned results are written by the function object to
+#  postProcessing/analyseT/<startTime>/results.bin, with the column names in
+#  results.columns, and can be read with:
+#      columns = open("results.columns").read().split()
+#      results = np.fromfile("results.bin").reshape(-1, len(columns))
+
+# Author
+#  Simon A. Rodriguez, UCD. All rights reserved
+#  Philip Cardiff, UCD. All rights reserved
+
+import numpy as np
+
+# fields is a dict of read-only views of the cell values:
+#  "T":       (N,) temperature
+#  "V":       (N,) cell volumes
+#  "grad(T)": (N, 3) temperature gradient
+def analyse(time, fields):
+    T = fields["T"]
+    V = fields["V"]
+    magGradT = np.linalg.norm(fields["grad(T)"], axis=1)
+
+    return {
+        "minT": T.min(),
+        "maxT": T.max(),
+        "meanT": np.dot(T, V)/V.sum(),
+        "maxMagGradT": magGradT.max(),
+        "meanGradT": np.average(fields["grad(T)"], axis=0, weights=V)
+    }
@@ -17,28 +17,34 @@
 # Description
 #  This script solves the heat equation using an explicit 2-D finite difference
 #  discretisation.
-#  It is assumed that:
+#  The calculate function is used with the default "exchangeMode field;" in
+#  the controlDict, where T is passed in the mesh cell order. It is assumed
+#  that:
 #  1 - The mesh comprises a single structured square mesh with an
 #     equal number of cells in the x and y directions, where the cell numbers
 #     increase row by row from one side to the other.
 #  2 - The number of cells in the X and Y directions are equal.
 #  3 - The boundary cell values have already been updated
+#  The calculateStructured function is used with "exchangeMode structured;"
+#  and "pythonFunction calculateStructured;" in the controlDict, where
+#  pythonLaplacianFoam finds the grid dimensions, spacing and cell ordering
+#  from the mesh, which should be a uniform structured 2-D grid (the number of
+#  cells in the x and y directions may differ, but the spacing should be the
+#  same), and sets the boundary cell values to the boundary values before
+#  each call.
 
 # Author
 #  Simon A. Rodriguez, UCD. All rights reserved
 #  Philip Cardiff, UCD. All rights reserved
 
 import numpy as np
-import ctypes as C
 
 # Calculate the temperature field T using gamma
-def calculate():
-
-    data_pointer_T = C.cast(T_address, C.POINTER(C.c_double))
-    T = np.ctypeslib.as_array(data_pointer_T, shape=(SIZE, 1))
+# T is an (N,) view of the OpenFOAM field and is updated in place
+def calculate(T, gamma):
 
     # Get number of cells in x and y directions
-    Nx = np.sqrt(SIZE).astype(int)
+    Nx = np.sqrt(T.shape[0]).astype(int)
     Ny = Nx
 
     # Reshape T to 2-D array
@@ -50,4 +56,21 @@ def calculate():
                                  + T2d[1:-1, :-2] - 4*T2d[1:-1, 1:-1])
                           + T2d[1:-1, 1:-1])
 
-    T[:, :] = np.reshape(newT2d, (SIZE, 1))
\ No newline at end of file
+    T[:] = np.reshape(newT2d, T.shape)
+
+# Calculate the new temperature field T_new from T using gamma
+# T and T_new are (Ny, Nx) views of the persistent grid buffers in
+# pythonLaplacianFoam, where the first and last rows and columns are the
+# boundary nodes. T is read-only and T_new is updated in place.
+def calculateStructured(T, T_new, gamma):
+
+    # The boundary nodes are unchanged
+    T_new[0, :] = T[0, :]
+    T_new[-1, :] = T[-1, :]
+    T_new[1:-1, 0] = T[1:-1, 0]
+    T_new[1:-1, -1] = T[1:-1, -1]
+
+    # Use explicit finite difference method to update the non-boundary cells
+    T_new[1:-1, 1:-1] = (gamma*(T[2:, 1:-1] + T[:-2, 1:-1] + T[1:-1, 2:]
+                                + T[1:-1, :-2] - 4*T[1:-1, 1:-1])
+                         + T[1:-1, 1:-1])